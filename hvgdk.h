@@ -1854,12 +1854,37 @@ typedef struct DECLSPEC_ALIGN(2) _HV_STATISTICS_GROUP_HEADER
 // Definition of the counters structure.
 //
 
+#define HV_STATS_PAGE_QWORD_COUNT (HV_PAGE_SIZE / sizeof(UINT64))
+
 typedef struct _HV_STATS_PAGE
 {
-    UINT64      Data[HV_PAGE_SIZE / sizeof(UINT64)];
+    UINT64      Data[HV_STATS_PAGE_QWORD_COUNT];
 
 } HV_STATS_PAGE, *PHV_STATS_PAGE;
 
+//
+// A stats page holds a chain of groups, each consisting of a header followed
+// by Length bytes of counters, terminated by a header whose Type is
+// HV_STATISTICS_GROUP_END_OF_LIST or HV_STATISTICS_GROUP_END_OF_PAGE. The
+// logical processor, partition and virtual processor counter enumerations
+// below are numbered by the UINT64 index of each counter within the page,
+// so once the group types, versions and lengths of such a page have been
+// validated, a counter is read directly as Data[Counter]. This does not hold
+// for the hypervisor counters, as the HVA group only covers counters 1 and 2;
+// the remaining hypervisor counters must be located by walking the groups
+// with HV_STATISTICS_GROUP_NEXT.
+//
+
+#define HV_STATISTICS_GROUP_NEXT(_Header_)                          \
+    ((PHV_STATISTICS_GROUP_HEADER)((PUINT8)((_Header_) + 1) +       \
+                                   (_Header_)->Length))
+
+#define HV_STATISTICS_GROUP_VERSION_VALUE(_Version_)                \
+    (((UINT32)(_Version_).Major << 16) | (UINT32)(_Version_).Minor)
+
+#define HV_STATS_PAGE_COUNTER(_Page_, _Counter_) \
+    ((_Page_)->Data[(_Counter_)])
+
 //
 // Definition for the stats object types.
 //
@@ -1882,6 +1907,8 @@ typedef enum _HV_STATS_OBJECT_TYPE
 
 } HV_STATS_OBJECT_TYPE;
 
+#define HV_STATS_OBJECT_TYPE_IS_LOCAL(_Type_) (((_Type_) & 0x00010000) != 0)
+
 //
 // Definition for the stats map/unmap MSR value.
 //
@@ -2053,6 +2080,26 @@ typedef enum _HV_THREAD_COUNTER
 #define HV_STATISTICS_GROUP_VPA_LENGTH 16
 #define HV_STATISTICS_GROUP_VPV_LENGTH 504
 
+//
+// The virtual processor counters from StVpCounterHypercallsCount through
+// StVpCounterPageFaultInterceptsTime come in pairs: the number of exits of a
+// given class, immediately followed by the total time spent handling them.
+//
+
+#define HV_THREAD_COUNTER_PAIR_COUNT \
+    (((StVpCounterPageFaultInterceptsTime - StVpCounterHypercallsCount) + 1) / 2)
+
+#define HV_THREAD_COUNTER_PAIR_COUNTER(_PairIndex_) \
+    ((HV_THREAD_COUNTER)(StVpCounterHypercallsCount + (2 * (_PairIndex_))))
+
+#define HV_THREAD_COUNTER_IS_PAIRED_COUNT(_Counter_)                    \
+    (((_Counter_) >= StVpCounterHypercallsCount) &&                     \
+     ((_Counter_) <= StVpCounterPageFaultInterceptsCount) &&            \
+     ((((_Counter_) - StVpCounterHypercallsCount) & 1) == 0))
+
+#define HV_THREAD_COUNTER_PAIRED_TIME(_Counter_) \
+    ((HV_THREAD_COUNTER)((_Counter_) + 1))
+
 //
 // Declare the timestamp type.
 //
@@ -2385,36 +2432,51 @@ typedef UINT32 HV_PROXIMITY_DOMAIN_ID, *PHV_PROXIMITY_DOMAIN_ID;
 // Define the proximity domain information flags.
 //
 
-typedef struct _HV_PROXIMITY_DOMAIN_FLAGS
+typedef union _HV_PROXIMITY_DOMAIN_FLAGS
 {
-    //
-    // This flag specifies whether the proximity information is preferred. If
-    // so, then the memory allocations are done preferentially from the
-    // specified proximity domain. In case there is insufficient memory in the
-    // specified domain, other domains are tried. If this flag is false, then
-    // all memory allocation must come from the specified domain.
-    //
-    UINT32 ProximityPreferred:1;
+    struct
+    {
+        //
+        // This flag specifies whether the proximity information is preferred. If
+        // so, then the memory allocations are done preferentially from the
+        // specified proximity domain. In case there is insufficient memory in the
+        // specified domain, other domains are tried. If this flag is false, then
+        // all memory allocation must come from the specified domain.
+        //
+        UINT32 ProximityPreferred:1;
 
-    UINT32 Reserved:30;
+        UINT32 Reserved:30;
 
-    //
-    // This flag specifies that the specified proximity domain is valid. If
-    // this flag is false then the memory allocation can come from any
-    // proximity domain.
-    //
-    UINT32 ProximityInfoValid:1;
+        //
+        // This flag specifies that the specified proximity domain is valid. If
+        // this flag is false then the memory allocation can come from any
+        // proximity domain.
+        //
+        UINT32 ProximityInfoValid:1;
+    };
+
+    UINT32 AsUINT32;
 
 } HV_PROXIMITY_DOMAIN_FLAGS, *PHV_PROXIMITY_DOMAIN_FLAGS;
 
+#define HV_PROXIMITY_DOMAIN_FLAG_PREFERRED  0x00000001
+#define HV_PROXIMITY_DOMAIN_FLAG_INFO_VALID 0x80000000
+
 //
-// Define the proximiy domain information structure.
+// Define the proximiy domain information structure. The whole structure fits
+// in a single register, so it can be passed by value to fast hypercalls.
 //
 
-typedef struct _HV_PROXIMITY_DOMAIN_INFO
+typedef union _HV_PROXIMITY_DOMAIN_INFO
 {
-    HV_PROXIMITY_DOMAIN_ID Id;
-    HV_PROXIMITY_DOMAIN_FLAGS Flags;
+    struct
+    {
+        HV_PROXIMITY_DOMAIN_ID Id;
+        HV_PROXIMITY_DOMAIN_FLAGS Flags;
+    };
+
+    UINT64 AsUINT64;
+
 } HV_PROXIMITY_DOMAIN_INFO, *PHV_PROXIMITY_DOMAIN_INFO;
 
 //
@@ -3268,8 +3330,19 @@ typedef UINT32 HV_PHYSICAL_NODE_INDEX, *PHV_PHYSICAL_NODE_INDEX;
 #define HV_X64_MSR_STIMER3_CONFIG      (0x400000b6)
 #define HV_X64_MSR_STIMER3_COUNT       (0x400000b7)
 
+#define HV_X64_MSR_STIMER_CONFIG(_Index_)   (HV_X64_MSR_STIMER0_CONFIG + (2 * (_Index_)))
+#define HV_X64_MSR_STIMER_COUNT(_Index_)    (HV_X64_MSR_STIMER0_COUNT + (2 * (_Index_)))
+
+//
+// Define the synthetic timer configuration structure.
 //
-// Define the synthetic timer configuration structure
+// For a one-shot timer the count register holds the absolute expiration time
+// in reference time units; for a Periodic timer it holds the period. With
+// AutoEnable set, writing a non-zero count also enables the timer. A Lazy
+// timer may have its expiration deferred by the hypervisor, which makes it
+// suitable for timers that can be coalesced. When DirectSyntheticTimers is
+// reported, DirectMode delivers ApicVector directly to the virtual processor
+// instead of posting an HV_TIMER_MESSAGE_PAYLOAD to SINTx.
 //
 typedef struct _HV_X64_MSR_STIMER_CONFIG_CONTENTS
 {
@@ -3376,6 +3449,21 @@ typedef struct _HV_REFERENCE_TSC_PAGE
     UINT64 Reserved2[508];
 } HV_REFERENCE_TSC_PAGE, *PHV_REFERENCE_TSC_PAGE;
 
+//
+// Reference time is derived from the TSC as
+//
+//     ReferenceTime = ((Tsc * TscScale) >> 64) + TscOffset
+//
+// using the high 64 bits of the 128-bit product. A reader samples
+// TscSequence, reads TscScale, TscOffset and the TSC, and retries if
+// TscSequence has changed in the meantime. While TscSequence is
+// HV_REFERENCE_TSC_SEQUENCE_INVALID the page must not be used, and reference
+// time is read from HV_X64_MSR_TIME_REF_COUNT instead.
+//
+#define HV_REFERENCE_TSC_TO_NANO100(_Tsc_, _TscScale_, _TscOffset_)  \
+    ((HV_NANO100_TIME)(UnsignedMultiplyHigh((_Tsc_), (_TscScale_)) + \
+                       (UINT64)(_TscOffset_)))
+
 typedef union _HV_PARTITION_PRIVILEGE_MASK
 {
     UINT64 AsUINT64;
@@ -3813,6 +3901,39 @@ typedef UINT32 HV_VP_INDEX, *PHV_VP_INDEX;
 #define HV_ANY_VP ((HV_VP_INDEX)-1)
 #define HV_VP_INDEX_SELF ((HV_VP_INDEX)-2) 
 
+//
+// Generic sets of virtual processors, used by the Ex forms of the flush and
+// IPI hypercalls to address more than 64 virtual processors. Processors are
+// divided into banks of 64. In the sparse format ValidBankMask has a bit set
+// for every bank which contains at least one processor, and BankContents
+// holds one mask per set bit in ascending bank order; banks without any
+// processor are omitted. The BankContents entries make up the variable
+// portion of the hypercall input header.
+//
+
+typedef enum _HV_GENERIC_SET_FORMAT
+{
+    HvGenericSetSparse4k = 0,
+    HvGenericSetAll = 1
+
+} HV_GENERIC_SET_FORMAT, *PHV_GENERIC_SET_FORMAT;
+
+#define HV_GENERIC_SET_BANK_SIZE    64
+#define HV_GENERIC_SET_MAX_BANKS    64
+
+#define HV_GENERIC_SET_BANK(_VpIndex_) \
+    ((_VpIndex_) / HV_GENERIC_SET_BANK_SIZE)
+
+#define HV_GENERIC_SET_BANK_BIT(_VpIndex_) \
+    ((UINT64)1 << ((_VpIndex_) % HV_GENERIC_SET_BANK_SIZE))
+
+typedef struct _HV_VP_SET
+{
+    UINT64 Format;
+    UINT64 ValidBankMask;
+    UINT64 BankContents[];
+} HV_VP_SET, *PHV_VP_SET;
+
 //
 // Declare the MSR for determining the current VP index.
 //
@@ -4590,8 +4711,34 @@ typedef union _HV_GVA_RANGE
 
         UINT64 GvaPageNumber   : 52;
     };
+
+    //
+    // Extended range format, used when HV_FLUSH_USE_EXTENDED_RANGE_FORMAT is
+    // specified. LargePage selects between the two forms; the large page form
+    // counts 2MB (PageSize clear) or 1GB (PageSize set) pages.
+    //
+
+    struct
+    {
+        UINT64 AdditionalPages : 11;
+        UINT64 LargePage       : 1;
+        UINT64 GvaPageNumber   : 52;
+    } Extended;
+
+    struct
+    {
+        UINT64 AdditionalPages    : 11;
+        UINT64 LargePage          : 1;
+        UINT64 PageSize           : 1;
+        UINT64 Reserved           : 8;
+        UINT64 GvaLargePageNumber : 43;
+    } ExtendedLargePage;
+
 } HV_GVA_RANGE, *PHV_GVA_RANGE;
 
+#define HV_GVA_RANGE_MAX_ADDITIONAL_PAGES           0xFFF
+#define HV_GVA_RANGE_EXTENDED_MAX_ADDITIONAL_PAGES  0x7FF
+
 typedef enum _HV_X64_SYNTHETIC_MSR
 {
     HvSyntheticMsrGuestOsId = 0x40000000,
@@ -4756,6 +4903,8 @@ typedef enum _HV_X64_SYNTHETIC_MSR
 #define HV_X64_MSR_SINT14     (0x4000009E)
 #define HV_X64_MSR_SINT15     (0x4000009F)
 
+#define HV_X64_MSR_SINT(_Index_) (HV_X64_MSR_SINT0 + (_Index_))
+
 //
 // Define the expected SynIC version.
 //
@@ -4776,6 +4925,7 @@ typedef enum _HV_X64_SYNTHETIC_MSR
 #define HV_EVENT_FLAGS_COUNT        (256 * 8)
 #define HV_EVENT_FLAGS_BYTE_COUNT   (256)
 #define HV_EVENT_FLAGS_DWORD_COUNT  (256 / sizeof(UINT32))
+#define HV_EVENT_FLAGS_QWORD_COUNT  (256 / sizeof(UINT64))
 
 //
 // Define hypervisor message types.
@@ -4842,6 +4992,27 @@ typedef enum _HV_MESSAGE_TYPE
 
 #define HV_MESSAGE_TYPE_HYPERVISOR_MASK (0x80000000)
 
+//
+// Hypervisor message types fall into a small number of dense ranges, so a
+// dispatcher can index a two level table by class and index instead of
+// comparing against each value. HvMessageTypeNone and non-hypervisor
+// message types must be filtered out before indexing.
+//
+
+#define HV_MESSAGE_TYPE_CLASS(_Type_)   (((UINT32)(_Type_) >> 16) & 0x7FFF)
+#define HV_MESSAGE_TYPE_INDEX(_Type_)   ((UINT32)(_Type_) & 0xFFFF)
+
+#define HV_MESSAGE_TYPE_CLASS_HYPERVISOR        0
+#define HV_MESSAGE_TYPE_CLASS_INTERCEPT         1
+#define HV_MESSAGE_TYPE_CLASS_COUNT             2
+
+#define HV_MESSAGE_TYPE_HYPERVISOR_INDEX_COUNT  0x200
+#define HV_MESSAGE_TYPE_INTERCEPT_INDEX_COUNT   0x10
+
+#define HV_MESSAGE_TYPE_IS_SCHEDULER(_Type_)                 \
+    (((_Type_) >= HvMessageTypeSchedulerIdRangeStart) &&     \
+     ((_Type_) <= HvMessageTypeSchedulerIdRangeEnd))
+
 
 //
 // Define APIC EOI message.
@@ -5017,6 +5188,8 @@ typedef union _HV_MESSAGE_FLAGS
     };
 } HV_MESSAGE_FLAGS, *PHV_MESSAGE_FLAGS;
 
+#define HV_MESSAGE_FLAG_MESSAGE_PENDING 0x01
+
 
 //
 // Define synthetic interrupt controller message header.
@@ -5047,6 +5220,16 @@ typedef struct _HV_TIMER_MESSAGE_PAYLOAD
     HV_NANO100_TIME DeliveryTime;       // When the message was delivered
 } HV_TIMER_MESSAGE_PAYLOAD, *PHV_TIMER_MESSAGE_PAYLOAD;
 
+//
+// The delivery skew of a timer message is the time between the expiration
+// of the timer and the delivery of its message, and grows when the target
+// logical processor is slow to service timer interrupts.
+//
+#define HV_TIMER_MESSAGE_DELIVERY_SKEW(_Payload_)                     \
+    ((HV_NANO100_DURATION)                                            \
+     (((_Payload_)->DeliveryTime > (_Payload_)->ExpirationTime) ?     \
+      ((_Payload_)->DeliveryTime - (_Payload_)->ExpirationTime) : 0))
+
 typedef enum _HV_IOMMU_FAULT_TYPE
 {
     HvIommuTranslationFault = 0,
@@ -5097,6 +5280,15 @@ typedef struct _HV_MESSAGE
     };
 } HV_MESSAGE, *PHV_MESSAGE;
 
+//
+// Typed view of a message payload, for payloads which are not members of
+// the HV_MESSAGE union (e.g. the intercept messages). The view is volatile,
+// as the message slots of the SIM page are written by the hypervisor.
+//
+
+#define HV_MESSAGE_PAYLOAD(_Message_, _PayloadType_) \
+    ((volatile _PayloadType_ *)(_Message_)->Payload)
+
 //
 // Define the number of message buffers associated with each port.
 //
@@ -5112,6 +5304,22 @@ typedef struct _HV_MESSAGE_PAGE
     volatile HV_MESSAGE SintMessage[HV_SYNIC_SINT_COUNT];
 } HV_MESSAGE_PAGE, *PHV_MESSAGE_PAGE;
 
+//
+// Each slot of the message page is HV_MESSAGE_SIZE bytes long and naturally
+// aligned, so a message can be copied out of the page as a whole. A slot is
+// released by writing HvMessageTypeNone to its MessageType. If the copied
+// header had MessagePending set, the hypervisor has further messages queued
+// for that SINT and will only deliver them after a write to HV_X64_MSR_EOM.
+// The EOM write must follow the release of the slot, and one write after a
+// pass over all slots covers every SINT which had a message pending. Such a
+// pass can track the SINTs with a message pending in a bitmap holding one bit
+// per SINT, HV_SYNIC_SINT_BITMAP_ALL having the bit of every SINT set. This
+// is unrelated to the Masked bit of HV_SYNIC_SINT.
+//
+
+#define HV_MESSAGE_QWORD_COUNT      (HV_MESSAGE_SIZE / sizeof(UINT64))
+#define HV_SYNIC_SINT_BITMAP_ALL    ((1 << HV_SYNIC_SINT_COUNT) - 1)
+
 
 //
 // Define the synthetic interrupt controller event flags format.
@@ -5121,8 +5329,20 @@ typedef union _HV_SYNIC_EVENT_FLAGS
 {
     UINT8 Flags8[HV_EVENT_FLAGS_BYTE_COUNT];
     UINT32 Flags32[HV_EVENT_FLAGS_DWORD_COUNT];
+    UINT64 Flags64[HV_EVENT_FLAGS_QWORD_COUNT];
 } HV_SYNIC_EVENT_FLAGS, *PHV_SYNIC_EVENT_FLAGS;
 
+//
+// The hypervisor sets flags with atomic operations, so a consumer locates
+// non-zero words and then atomically exchanges each with zero before
+// processing the bits it contained. Flag numbers map to words as follows.
+//
+
+#define HV_EVENT_FLAGS_QWORD_INDEX(_FlagNumber_)    ((_FlagNumber_) / 64)
+#define HV_EVENT_FLAGS_QWORD_BIT(_FlagNumber_)      ((UINT64)1 << ((_FlagNumber_) % 64))
+#define HV_EVENT_FLAGS_FLAG_NUMBER(_QwordIndex_, _Bit_) \
+    (((_QwordIndex_) * 64) + (_Bit_))
+
 
 //
 // Define the synthetic interrupt flags page layout.
@@ -5160,10 +5380,18 @@ typedef union _HV_SYNIC_SINT
         UINT64 Reserved1 :8;
         UINT64 Masked    :1;
         UINT64 AutoEoi   :1;
-        UINT64 Reserved2 :46;
+        UINT64 Polling   :1;
+        UINT64 Reserved2 :45;
     };
 } HV_SYNIC_SINT, *PHV_SYNIC_SINT;
 
+//
+// Every SINT register is masked when the virtual processor is created or
+// reset.
+//
+
+#define HV_SYNIC_SINT_RESET_VALUE   0x0000000000010000
+
 //
 // Define the format of the SIMP register
 //
@@ -5290,6 +5518,29 @@ typedef union _HV_PM_TIMER_INFO
 // Definitions for the monitored notification facility
 //
 
+//
+// Monitored notifications. Each monitor id names one Pending bit in one of
+// the trigger groups. Instead of calling HvCallSignalEvent, a sender sets
+// the bit for its monitor id with an interlocked OR. For each group enabled
+// in TriggerState, the monitor checks the Pending bits which are also Armed,
+// and signals the event described by the matching Parameter entry.
+//
+
+#define HV_MONITOR_TRIGGER_GROUP_COUNT  4
+#define HV_MONITOR_FLAGS_PER_GROUP      32
+#define HV_MONITOR_FLAG_COUNT           (HV_MONITOR_TRIGGER_GROUP_COUNT * \
+                                         HV_MONITOR_FLAGS_PER_GROUP)
+
+#define HV_MONITOR_GROUP(_MonitorId_)       ((_MonitorId_) / HV_MONITOR_FLAGS_PER_GROUP)
+#define HV_MONITOR_FLAG(_MonitorId_)        ((_MonitorId_) % HV_MONITOR_FLAGS_PER_GROUP)
+#define HV_MONITOR_FLAG_BIT(_MonitorId_)    ((UINT32)1 << HV_MONITOR_FLAG(_MonitorId_))
+
+//
+// Per monitor latency values in the monitor page.
+//
+
+typedef UINT16 HV_MONITOR_LATENCY, *PHV_MONITOR_LATENCY;
+
 typedef union _HV_MONITOR_TRIGGER_GROUP
 {
     UINT64 AsUINT64;
@@ -5347,16 +5598,16 @@ typedef struct _HV_MONITOR_PAGE
     HV_MONITOR_TRIGGER_STATE TriggerState;
     UINT32                   RsvdZ1;
 
-    HV_MONITOR_TRIGGER_GROUP TriggerGroup[4];
+    HV_MONITOR_TRIGGER_GROUP TriggerGroup[HV_MONITOR_TRIGGER_GROUP_COUNT];
     UINT64                   RsvdZ2[3]; // 64
 
-    UINT16                   NextCheckTime[4][32]; // 256
+    UINT16                   NextCheckTime[HV_MONITOR_TRIGGER_GROUP_COUNT][HV_MONITOR_FLAGS_PER_GROUP]; // 256
     UINT64                   RsvdZ3[32]; // 256
 
-    UINT16                   Latency[4][32]; // 256
+    HV_MONITOR_LATENCY       Latency[HV_MONITOR_TRIGGER_GROUP_COUNT][HV_MONITOR_FLAGS_PER_GROUP]; // 256
     UINT64                   RsvdZ4[32]; // 256
 
-    HV_MONITOR_PARAMETER     Parameter[4][32]; // 1024
+    HV_MONITOR_PARAMETER     Parameter[HV_MONITOR_TRIGGER_GROUP_COUNT][HV_MONITOR_FLAGS_PER_GROUP]; // 1024
 
     UINT8                    RsvdZ5[1984];
 
@@ -6187,6 +6438,45 @@ typedef struct HV_CALL_ATTRIBUTES _HV_OUTPUT_GET_NEXT_CHILD_PARTITION
 //
 #define HV_X64_MAX_HYPERCALL_ELEMENTS ((1<<12) - 1)
 
+//
+// The register based (IsFast) form passes the input in RDX and R8 and returns
+// no output data.
+//
+#define HV_X64_FAST_HYPERCALL_INPUT_SIZE (2 * sizeof(UINT64))
+
+//
+// The extended (XMM) fast form additionally passes input in XMM0-XMM5 when
+// XmmRegistersForFastHypercallAvailable is reported. When the partition holds
+// the FastHypercallOutput privilege and FastHypercallOutputAvailable is
+// reported, output is returned in the XMM registers which follow those
+// consumed by the input. The register block mirrors the order in which the
+// input is loaded, so input structures can be copied into it directly.
+//
+#define HV_X64_FAST_HYPERCALL_XMM_REGISTER_COUNT 6
+
+#define HV_X64_XMM_FAST_HYPERCALL_INPUT_SIZE                \
+    (HV_X64_FAST_HYPERCALL_INPUT_SIZE +                     \
+     (HV_X64_FAST_HYPERCALL_XMM_REGISTER_COUNT * sizeof(HV_UINT128)))
+
+#define HV_X64_XMM_FAST_HYPERCALL_OUTPUT_SIZE(_InputSize_)  \
+    (HV_X64_XMM_FAST_HYPERCALL_INPUT_SIZE -                 \
+     (((_InputSize_) < HV_X64_FAST_HYPERCALL_INPUT_SIZE) ?  \
+      HV_X64_FAST_HYPERCALL_INPUT_SIZE :                    \
+      (((_InputSize_) + sizeof(HV_UINT128) - 1) & ~(sizeof(HV_UINT128) - 1))))
+
+typedef union DECLSPEC_ALIGN(16) _HV_X64_FAST_HYPERCALL_REGISTERS
+{
+    struct
+    {
+        UINT64     Rdx;
+        UINT64     R8;
+        HV_UINT128 Xmm[HV_X64_FAST_HYPERCALL_XMM_REGISTER_COUNT];
+    };
+    UINT8  AsUINT8[HV_X64_XMM_FAST_HYPERCALL_INPUT_SIZE];
+    UINT64 AsUINT64[HV_X64_XMM_FAST_HYPERCALL_INPUT_SIZE / sizeof(UINT64)];
+
+} HV_X64_FAST_HYPERCALL_REGISTERS, *PHV_X64_FAST_HYPERCALL_REGISTERS;
+
 typedef union _HV_X64_HYPERCALL_INPUT
 {
     //
@@ -6194,13 +6484,14 @@ typedef union _HV_X64_HYPERCALL_INPUT
     //
     struct
     {
-        UINT32 CallCode        : 16; // Least significant bits
-        UINT32 IsFast          : 1;  // Uses the register based form
-        UINT32 Reserved1       : 15;
-        UINT32 CountOfElements : 12;
-        UINT32 Reserved2       : 4;
-        UINT32 RepStartIndex   : 12;
-        UINT32 Reserved3       : 4;  // Most significant bits
+        UINT32 CallCode           : 16; // Least significant bits
+        UINT32 IsFast             : 1;  // Uses the register based form
+        UINT32 VariableHeaderSize : 10; // In units of UINT64
+        UINT32 Reserved1          : 5;
+        UINT32 CountOfElements    : 12;
+        UINT32 Reserved2          : 4;
+        UINT32 RepStartIndex      : 12;
+        UINT32 Reserved3          : 4;  // Most significant bits
     };
     UINT64 AsUINT64;
 
@@ -6222,6 +6513,75 @@ typedef union _HV_X64_HYPERCALL_OUTPUT
 
 } HV_X64_HYPERCALL_OUTPUT, *PHV_X64_HYPERCALL_OUTPUT;
 
+//
+// Helpers for rep hypercalls. The number of elements passed in one call is
+// bounded both by the CountOfElements field and by the amount of data which
+// fits in a single input (or output) page after the fixed size header.
+//
+#define HV_X64_MAX_HYPERCALL_ELEMENTS_PER_PAGE(_HeaderSize_, _ElementSize_)         \
+    ((((HV_PAGE_SIZE - (_HeaderSize_)) / (_ElementSize_)) >                         \
+      HV_X64_MAX_HYPERCALL_ELEMENTS) ?                                              \
+     HV_X64_MAX_HYPERCALL_ELEMENTS :                                                \
+     ((HV_PAGE_SIZE - (_HeaderSize_)) / (_ElementSize_)))
+
+//
+// The count and start index must both be at most HV_X64_MAX_HYPERCALL_ELEMENTS
+// (the count is normally bounded by HV_X64_MAX_HYPERCALL_ELEMENTS_PER_PAGE).
+// HV_X64_HYPERCALL_REP_INPUT does not check this: a larger count spills into
+// the reserved bits or into RepStartIndex, and a larger start index spills
+// into the reserved bits or is shifted out of the control word. Callers check
+// values which are not known to be in range with the macros below first.
+//
+#define HV_X64_HYPERCALL_REP_COUNT_IS_VALID(_CountOfElements_) \
+    ((_CountOfElements_) <= HV_X64_MAX_HYPERCALL_ELEMENTS)
+
+#define HV_X64_HYPERCALL_REP_START_INDEX_IS_VALID(_RepStartIndex_) \
+    ((_RepStartIndex_) <= HV_X64_MAX_HYPERCALL_ELEMENTS)
+
+#define HV_X64_HYPERCALL_REP_INPUT(_CallCode_, _CountOfElements_, _RepStartIndex_) \
+    ((UINT64)(UINT16)(_CallCode_) |                                                 \
+     ((UINT64)(_CountOfElements_) << 32) |                                          \
+     ((UINT64)(_RepStartIndex_) << 48))
+
+//
+// A rep hypercall which fails part way through returns the index of the first
+// element which was not processed in ElementsProcessed. Once the cause of the
+// failure has been dealt with (for example by depositing more memory following
+// HV_STATUS_INSUFFICIENT_MEMORY), the call is resumed by reissuing it with the
+// same input page and RepStartIndex set to that value; the elements themselves
+// do not need to be copied again.
+//
+#define HV_X64_HYPERCALL_REP_COMPLETE(_Input_, _Output_) \
+    ((_Output_).ElementsProcessed == (_Input_).CountOfElements)
+
+//
+// Hypercall input and output pages. The input and output of a memory based
+// hypercall must each lie within a single page, so callers typically keep a
+// page aligned input/output pair per processor and reuse it for every call.
+// The hypervisor only reads the bytes described by the call, so only those
+// (the fixed header plus CountOfElements trailing elements) need to be
+// initialized before each call.
+//
+typedef union DECLSPEC_ALIGN(HV_PAGE_SIZE) _HV_HYPERCALL_PAGE
+{
+    UINT8  AsUINT8[HV_PAGE_SIZE];
+    UINT64 AsUINT64[HV_PAGE_SIZE / sizeof(UINT64)];
+
+} HV_HYPERCALL_PAGE, *PHV_HYPERCALL_PAGE;
+
+typedef struct _HV_HYPERCALL_PAGES
+{
+    HV_HYPERCALL_PAGE Input;
+    HV_HYPERCALL_PAGE Output;
+
+} HV_HYPERCALL_PAGES, *PHV_HYPERCALL_PAGES;
+
+#define HV_HYPERCALL_PAGE_BYTES_USED(_HeaderSize_, _ElementSize_, _Count_) \
+    ((_HeaderSize_) + ((_ElementSize_) * (_Count_)))
+
+#define HV_HYPERCALL_PAGE_ELEMENTS(_Page_, _HeaderSize_, _ElementType_)    \
+    ((_ElementType_ *)&(_Page_)->AsUINT8[(_HeaderSize_)])
+
 //
 // Declare the various hypercall operations.
 //
@@ -6740,6 +7100,10 @@ typedef struct HV_CALL_ATTRIBUTES _HV_INPUT_DEPOSIT_MEMORY
 
 } HV_INPUT_DEPOSIT_MEMORY, *PHV_INPUT_DEPOSIT_MEMORY;
 
+#define HV_DEPOSIT_MEMORY_MAX_ELEMENTS                          \
+    HV_X64_MAX_HYPERCALL_ELEMENTS_PER_PAGE(sizeof(HV_INPUT_DEPOSIT_MEMORY), \
+                                           sizeof(HV_GPA_PAGE_NUMBER))
+
 //
 // Definition of the HvCallWithdrawMemory hypercall input and output
 // structures.  This call withdraws memory from a child partition's
@@ -6771,6 +7135,9 @@ typedef struct HV_CALL_ATTRIBUTES _HV_OUTPUT_WITHDRAW_MEMORY
 
 } HV_OUTPUT_WITHDRAW_MEMORY, *PHV_OUTPUT_WITHDRAW_MEMORY;
 
+#define HV_WITHDRAW_MEMORY_MAX_ELEMENTS                         \
+    HV_X64_MAX_HYPERCALL_ELEMENTS_PER_PAGE(0, sizeof(HV_GPA_PAGE_NUMBER))
+
 //
 // Definition of the HvCallGetMemoryBalance hypercall input and output
 // structures.  This call determines the hypervisor memory resource
@@ -6807,6 +7174,16 @@ typedef struct HV_CALL_ATTRIBUTES _HV_OUTPUT_GET_MEMORY_BALANCE
 
 } HV_OUTPUT_GET_MEMORY_BALANCE, *PHV_OUTPUT_GET_MEMORY_BALANCE;
 
+//
+// Hypercalls which need to allocate hypervisor memory on behalf of a child
+// partition (creating virtual processors, mapping GPA pages, etc.) fail with
+// HV_STATUS_INSUFFICIENT_MEMORY when the partition's pool is exhausted. The
+// caller deposits more pages with HvCallDepositMemory and reissues the call;
+// rep calls resume from ElementsProcessed. Keeping PagesAvailable from
+// HvCallGetMemoryBalance above a low watermark for each proximity domain
+// avoids taking that path on every call.
+//
+
 //
 // Definition of the HvCallMapGpaPages hypercall input structure.
 // This call maps a range of GPA to a supplied range of SPA.
@@ -6842,6 +7219,10 @@ typedef struct HV_CALL_ATTRIBUTES _HV_INPUT_MAP_GPA_PAGES
 
 } HV_INPUT_MAP_GPA_PAGES, *PHV_INPUT_MAP_GPA_PAGES;
 
+#define HV_MAP_GPA_PAGES_MAX_ELEMENTS                           \
+    HV_X64_MAX_HYPERCALL_ELEMENTS_PER_PAGE(sizeof(HV_INPUT_MAP_GPA_PAGES), \
+                                           sizeof(HV_GPA_PAGE_NUMBER))
+
 //
 // Definition of the HvCallMapSparseGpaPages hypercall input structure.
 // This call maps a range of GPA to a supplied range of SPA.
@@ -6875,6 +7256,36 @@ typedef struct HV_CALL_ATTRIBUTES _HV_INPUT_MAP_SPARSE_GPA_PAGES
 
 } HV_INPUT_MAP_SPARSE_GPA_PAGES, *PHV_INPUT_MAP_SPARSE_GPA_PAGES;
 
+#define HV_MAP_SPARSE_GPA_PAGES_MAX_ELEMENTS                    \
+    HV_X64_MAX_HYPERCALL_ELEMENTS_PER_PAGE(sizeof(HV_INPUT_MAP_SPARSE_GPA_PAGES), \
+                                           sizeof(HV_GPA_MAPPING))
+
+//
+// A run of mappings whose target page numbers advance by one can be issued
+// through HvCallMapGpaPages, which takes the run as TargetGpaBase plus a list
+// of source pages, costs half as much input per page and maps twice as many
+// pages per call as HvCallMapSparseGpaPages. The source pages of such a run
+// need not be contiguous. MapFlags apply to the whole call in both forms, so
+// only mappings requested with the same flags can be combined into one run.
+//
+// Where the source pages of a run also advance by one, and both target and
+// source are aligned to a large (2MB) or huge (1GB) page, the hypervisor may
+// use large mappings, so such runs should not be split across a large page
+// boundary where it can be avoided.
+//
+#define HV_GPA_PAGES_PER_LARGE_PAGE 0x200
+#define HV_GPA_PAGES_PER_HUGE_PAGE  0x40000
+
+#define HV_GPA_PAGE_NUMBER_IS_ALIGNED(_PageNumber_, _PageCount_) \
+    (((_PageNumber_) & ((_PageCount_) - 1)) == 0)
+
+#define HV_GPA_MAPPING_IS_CONTIGUOUS(_Previous_, _Next_) \
+    (((_Previous_).TargetGpaPageNumber + 1) == (_Next_).TargetGpaPageNumber)
+
+#define HV_GPA_MAPPING_IS_SOURCE_CONTIGUOUS(_Previous_, _Next_) \
+    (HV_GPA_MAPPING_IS_CONTIGUOUS((_Previous_), (_Next_)) &&     \
+     (((_Previous_).SourceGpaPageNumber + 1) == (_Next_).SourceGpaPageNumber))
+
 //
 // Definition of the HvCallUnmapGpaPages hypercall input structure.
 // This call unmaps a range of GPA.
@@ -7606,6 +8017,13 @@ typedef struct HV_CALL_ATTRIBUTES _HV_INPUT_GET_VP_REGISTERS
     HV_REGISTER_NAME    Names[];
 } HV_INPUT_GET_VP_REGISTERS, *PHV_INPUT_GET_VP_REGISTERS;
 
+//
+// The number of registers retrieved in one call is bounded by the output page,
+// which holds fewer values than the input page holds names.
+//
+#define HV_GET_VP_REGISTERS_MAX_ELEMENTS                        \
+    HV_X64_MAX_HYPERCALL_ELEMENTS_PER_PAGE(0, sizeof(HV_REGISTER_VALUE))
+
 typedef struct _HV_REGISTER_ASSOC
 {
     HV_REGISTER_NAME    Name;
@@ -7680,6 +8098,74 @@ typedef struct HV_CALL_ATTRIBUTES _HV_INPUT_FLUSH_VIRTUAL_ADDRESS_LIST
     HV_GVA GvaList[];
 } HV_INPUT_FLUSH_VIRTUAL_ADDRESS_LIST, *PHV_INPUT_FLUSH_VIRTUAL_ADDRESS_LIST;
 
+//
+// Definition of the HvCallFlushVirtualAddressSpaceEx and
+// HvCallFlushVirtualAddressListEx hypercall input structures.  These are
+// the forms of the flush calls which take a generic processor set, and are
+// used when UseExProcessorMasks is recommended.  The processor set is laid
+// out as in HV_VP_SET.  BankContents is the variable portion of the input
+// header, with VariableHeaderSize set to the number of banks present.  For
+// the list form, the GVA ranges follow the bank contents.
+//
+
+typedef struct HV_CALL_ATTRIBUTES _HV_INPUT_FLUSH_VIRTUAL_ADDRESS_SPACE_EX
+{
+    HV_ADDRESS_SPACE_ID AddressSpace;
+    HV_FLUSH_FLAGS      Flags;
+    UINT64              ProcessorSetFormat;
+    UINT64              ValidBankMask;
+    UINT64              BankContents[];
+} HV_INPUT_FLUSH_VIRTUAL_ADDRESS_SPACE_EX,
+  *PHV_INPUT_FLUSH_VIRTUAL_ADDRESS_SPACE_EX;
+
+typedef struct HV_CALL_ATTRIBUTES _HV_INPUT_FLUSH_VIRTUAL_ADDRESS_LIST_EX
+{
+    HV_ADDRESS_SPACE_ID AddressSpace;
+    HV_FLUSH_FLAGS      Flags;
+    UINT64              ProcessorSetFormat;
+    UINT64              ValidBankMask;
+    UINT64              BankContents[];
+} HV_INPUT_FLUSH_VIRTUAL_ADDRESS_LIST_EX,
+  *PHV_INPUT_FLUSH_VIRTUAL_ADDRESS_LIST_EX;
+
+//
+// Definition of the HvCallSendSyntheticClusterIpi and
+// HvCallSendSyntheticClusterIpiEx hypercall input structures.  These calls
+// send a fixed interrupt to a set of virtual processors.
+//
+
+typedef struct HV_CALL_ATTRIBUTES _HV_INPUT_SEND_SYNTHETIC_CLUSTER_IPI
+{
+    UINT32       Vector;
+    HV_INPUT_VTL TargetVtl;
+    UINT8        ReservedZ0;
+    UINT16       ReservedZ1;
+    UINT64       ProcessorMask;
+} HV_INPUT_SEND_SYNTHETIC_CLUSTER_IPI, *PHV_INPUT_SEND_SYNTHETIC_CLUSTER_IPI;
+
+typedef struct HV_CALL_ATTRIBUTES _HV_INPUT_SEND_SYNTHETIC_CLUSTER_IPI_EX
+{
+    UINT32       Vector;
+    HV_INPUT_VTL TargetVtl;
+    UINT8        ReservedZ0;
+    UINT16       ReservedZ1;
+    UINT64       ProcessorSetFormat;
+    UINT64       ValidBankMask;
+    UINT64       BankContents[];
+} HV_INPUT_SEND_SYNTHETIC_CLUSTER_IPI_EX,
+  *PHV_INPUT_SEND_SYNTHETIC_CLUSTER_IPI_EX;
+
+#define HV_FLUSH_VIRTUAL_ADDRESS_LIST_MAX_ELEMENTS              \
+    HV_X64_MAX_HYPERCALL_ELEMENTS_PER_PAGE(sizeof(HV_INPUT_FLUSH_VIRTUAL_ADDRESS_LIST), \
+                                           sizeof(HV_GVA))
+
+//
+// Each GvaList entry is encoded as an HV_GVA_RANGE, so adjacent pages should
+// be merged into a single entry. A list which would exceed
+// HV_FLUSH_VIRTUAL_ADDRESS_LIST_MAX_ELEMENTS entries is generally better
+// issued as a single HvCallFlushVirtualAddressSpace.
+//
+
 //
 // Definition of the HvAssertVirtualInterrupt hypercall input
 // structure.  This call asserts an interrupt in a guest partition.
@@ -7792,6 +8278,25 @@ typedef struct HV_CALL_ATTRIBUTES _HV_INPUT_POST_MESSAGE
     UINT64              Payload[HV_MESSAGE_PAYLOAD_QWORD_COUNT];
 } HV_INPUT_POST_MESSAGE, *PHV_INPUT_POST_MESSAGE;
 
+//
+// The payload can be built in place in the hypercall input page, and only
+// the header and PayloadSize bytes (rounded up to a UINT64) are consumed.
+// Consecutive posts to the same connection only need to rewrite the payload
+// and PayloadSize. HV_STATUS_INSUFFICIENT_BUFFERS indicates that all of the
+// target port's message buffers are in use; the post may be retried once
+// the receiver has consumed a message.
+//
+
+#define HV_INPUT_POST_MESSAGE_HEADER_SIZE \
+    (sizeof(HV_INPUT_POST_MESSAGE) - HV_MESSAGE_PAYLOAD_BYTE_COUNT)
+
+#define HV_INPUT_POST_MESSAGE_SIZE(_PayloadSize_)   \
+    (HV_INPUT_POST_MESSAGE_HEADER_SIZE +            \
+     (((_PayloadSize_) + sizeof(UINT64) - 1) & ~(sizeof(UINT64) - 1)))
+
+#define HV_INPUT_POST_MESSAGE_PAYLOAD(_Input_, _PayloadType_) \
+    ((_PayloadType_ *)(_Input_)->Payload)
+
 
 //
 // Definition of the HvSignalEvent hypercall input structure.
@@ -8004,6 +8509,339 @@ typedef struct HV_CALL_ATTRIBUTES _HV_INPUT_SET_SYSTEM_PROPERTY
 
 } HV_INPUT_SET_SYSTEM_PROPERTY, *PHV_INPUT_SET_SYSTEM_PROPERTY;
 
+//
+// Hypercall descriptors. For each call code with a defined input or output
+// structure, the descriptor table supplies the size of the fixed portion of
+// the input and output, the size of each input and output rep element and
+// whether the call is a rep call. Sizes are zero where there is no data.
+// The table is expanded with a caller supplied macro of the form
+//
+//     _Entry_(CallCode, InputSize, OutputSize,
+//             InputElementSize, OutputElementSize, IsRep)
+//
+// so that the choice between the register (IsFast) and memory based forms,
+// and checks against HV_CALL_ALIGNMENT, can be made at compile time.
+//
+// For calls with a variable size input header, InputSize covers only the
+// fixed portion of the header. The caller supplies VariableHeaderSize in the
+// control word, and any rep elements start at HV_CALL_ELEMENT_OFFSET. As the
+// total input size of these calls is only known at run time, they are never
+// classified as fast capable.
+//
+
+#define HV_CALL_HAS_VARIABLE_HEADER(_CallCode_)                 \
+    (((_CallCode_) == HvCallFlushVirtualAddressSpaceEx) ||      \
+     ((_CallCode_) == HvCallFlushVirtualAddressListEx) ||       \
+     ((_CallCode_) == HvCallSendSyntheticClusterIpiEx))
+
+#define HV_CALL_ELEMENT_OFFSET(_InputSize_, _VariableHeaderSize_) \
+    ((_InputSize_) + ((_VariableHeaderSize_) * sizeof(UINT64)))
+
+typedef struct _HV_CALL_DESCRIPTOR
+{
+    HV_CALL_CODE CallCode;
+    UINT16       InputSize;
+    UINT16       OutputSize;
+    UINT16       InputElementSize;
+    UINT16       OutputElementSize;
+    UINT32       IsRep            : 1;
+    UINT32       IsFastCapable    : 1;
+    UINT32       IsXmmFastCapable : 1;
+    UINT32       IsVariableHeader : 1;
+    UINT32       Reserved         : 28;
+} HV_CALL_DESCRIPTOR, *PHV_CALL_DESCRIPTOR;
+
+typedef const HV_CALL_DESCRIPTOR *PCHV_CALL_DESCRIPTOR;
+
+//
+// A call is classified as fast capable if its fixed input and output, plus
+// one input and one output element for rep calls, fit in the registers of
+// the respective form.
+//
+#define HV_CALL_IS_FAST_CAPABLE(_InputSize_, _OutputSize_,                  \
+                                _InputElementSize_, _OutputElementSize_)    \
+    ((((_InputSize_) + (_InputElementSize_)) <=                             \
+      HV_X64_FAST_HYPERCALL_INPUT_SIZE) &&                                  \
+     (((_OutputSize_) + (_OutputElementSize_)) == 0))
+
+#define HV_CALL_IS_XMM_FAST_CAPABLE(_InputSize_, _OutputSize_,              \
+                                    _InputElementSize_, _OutputElementSize_) \
+    ((((_InputSize_) + (_InputElementSize_)) <=                             \
+      HV_X64_XMM_FAST_HYPERCALL_INPUT_SIZE) &&                              \
+     (((_OutputSize_) + (_OutputElementSize_)) <                            \
+      (HV_X64_XMM_FAST_HYPERCALL_OUTPUT_SIZE((_InputSize_) +                \
+                                             (_InputElementSize_)) + 1)))
+
+//
+// The number of rep elements which fit in one fast call is the largest count
+// for which both the input and the output fit. An element size of zero
+// places no limit on that side, so a call whose elements carry no data at
+// all is limited only by HV_X64_MAX_HYPERCALL_ELEMENTS. In the XMM form the
+// output follows the input rounded up to a 16 byte register, so the count is
+// evaluated for each number of input registers and the largest is taken.
+// Both are zero if no element fits.
+//
+#define HV_X64_FAST_HYPERCALL_MIN(_A_, _B_) (((_A_) < (_B_)) ? (_A_) : (_B_))
+#define HV_X64_FAST_HYPERCALL_MAX(_A_, _B_) (((_A_) > (_B_)) ? (_A_) : (_B_))
+
+#define HV_X64_FAST_HYPERCALL_ELEMENT_LIMIT(_Space_, _Used_, _ElementSize_) \
+    ((((_Space_) + 1) > (_Used_)) ?                                         \
+     (((_ElementSize_) == 0) ? HV_X64_MAX_HYPERCALL_ELEMENTS :              \
+      (((_Space_) - (_Used_)) /                                             \
+       ((_ElementSize_) + ((_ElementSize_) == 0)))) : 0)
+
+#define HV_X64_FAST_HYPERCALL_MAX_ELEMENTS(_InputSize_, _OutputSize_,       \
+                                           _InputElementSize_,              \
+                                           _OutputElementSize_)             \
+    ((((_OutputSize_) + (_OutputElementSize_)) != 0) ? 0 :                  \
+     HV_X64_FAST_HYPERCALL_ELEMENT_LIMIT(HV_X64_FAST_HYPERCALL_INPUT_SIZE,  \
+                                         (_InputSize_),                     \
+                                         (_InputElementSize_)))
+
+#define HV_X64_XMM_FAST_HYPERCALL_REGISTER_ELEMENTS(_InputSize_,            \
+                                                    _OutputSize_,           \
+                                                    _InputElementSize_,     \
+                                                    _OutputElementSize_,    \
+                                                    _Registers_)            \
+    HV_X64_FAST_HYPERCALL_MIN(                                              \
+        HV_X64_FAST_HYPERCALL_ELEMENT_LIMIT(                                \
+            ((_Registers_) * sizeof(HV_UINT128)),                           \
+            (_InputSize_), (_InputElementSize_)),                           \
+        HV_X64_FAST_HYPERCALL_ELEMENT_LIMIT(                                \
+            (HV_X64_XMM_FAST_HYPERCALL_INPUT_SIZE -                         \
+             ((_Registers_) * sizeof(HV_UINT128))),                         \
+            (_OutputSize_), (_OutputElementSize_)))
+
+#define HV_X64_XMM_FAST_HYPERCALL_MAX_ELEMENTS(_InputSize_, _OutputSize_,   \
+                                               _InputElementSize_,          \
+                                               _OutputElementSize_)         \
+    HV_X64_FAST_HYPERCALL_MAX(                                              \
+        HV_X64_FAST_HYPERCALL_MAX(                                          \
+            HV_X64_FAST_HYPERCALL_MAX(                                      \
+                HV_X64_XMM_FAST_HYPERCALL_REGISTER_ELEMENTS(                \
+                    (_InputSize_), (_OutputSize_),                          \
+                    (_InputElementSize_), (_OutputElementSize_), 1),        \
+                HV_X64_XMM_FAST_HYPERCALL_REGISTER_ELEMENTS(                \
+                    (_InputSize_), (_OutputSize_),                          \
+                    (_InputElementSize_), (_OutputElementSize_), 2)),       \
+            HV_X64_FAST_HYPERCALL_MAX(                                      \
+                HV_X64_XMM_FAST_HYPERCALL_REGISTER_ELEMENTS(                \
+                    (_InputSize_), (_OutputSize_),                          \
+                    (_InputElementSize_), (_OutputElementSize_), 3),        \
+                HV_X64_XMM_FAST_HYPERCALL_REGISTER_ELEMENTS(                \
+                    (_InputSize_), (_OutputSize_),                          \
+                    (_InputElementSize_), (_OutputElementSize_), 4))),      \
+        HV_X64_FAST_HYPERCALL_MAX(                                          \
+            HV_X64_FAST_HYPERCALL_MAX(                                      \
+                HV_X64_XMM_FAST_HYPERCALL_REGISTER_ELEMENTS(                \
+                    (_InputSize_), (_OutputSize_),                          \
+                    (_InputElementSize_), (_OutputElementSize_), 5),        \
+                HV_X64_XMM_FAST_HYPERCALL_REGISTER_ELEMENTS(                \
+                    (_InputSize_), (_OutputSize_),                          \
+                    (_InputElementSize_), (_OutputElementSize_), 6)),       \
+            HV_X64_XMM_FAST_HYPERCALL_REGISTER_ELEMENTS(                    \
+                (_InputSize_), (_OutputSize_),                              \
+                (_InputElementSize_), (_OutputElementSize_), 7)))
+
+#define HV_CALL_SIZE_IS_ALIGNED(_Size_) \
+    (((_Size_) & (HV_CALL_ALIGNMENT - 1)) == 0)
+
+#define HV_CALL_DESCRIPTOR_INITIALIZER(_CallCode_, _InputSize_, _OutputSize_,   \
+                                       _InputElementSize_, _OutputElementSize_, \
+                                       _IsRep_)                                 \
+    {                                                                           \
+        (_CallCode_),                                                           \
+        (UINT16)(_InputSize_),                                                  \
+        (UINT16)(_OutputSize_),                                                 \
+        (UINT16)(_InputElementSize_),                                           \
+        (UINT16)(_OutputElementSize_),                                          \
+        (_IsRep_),                                                              \
+        !HV_CALL_HAS_VARIABLE_HEADER(_CallCode_) &&                             \
+        HV_CALL_IS_FAST_CAPABLE((_InputSize_), (_OutputSize_),                  \
+                                (_InputElementSize_), (_OutputElementSize_)),   \
+        !HV_CALL_HAS_VARIABLE_HEADER(_CallCode_) &&                             \
+        HV_CALL_IS_XMM_FAST_CAPABLE((_InputSize_), (_OutputSize_),              \
+                                    (_InputElementSize_), (_OutputElementSize_)), \
+        HV_CALL_HAS_VARIABLE_HEADER(_CallCode_),                                \
+        0                                                                       \
+    },
+
+#define HV_CALL_DESCRIPTOR_TABLE(_Entry_) \
+    _Entry_(HvCallSwitchVirtualAddressSpace,                                                          \
+            sizeof(HV_INPUT_SWITCH_VIRTUAL_ADDRESS_SPACE), 0,                                         \
+            0, 0, 0)                                                                                  \
+    _Entry_(HvCallFlushVirtualAddressSpace,                                                           \
+            sizeof(HV_INPUT_FLUSH_VIRTUAL_ADDRESS_SPACE), 0,                                          \
+            0, 0, 0)                                                                                  \
+    _Entry_(HvCallFlushVirtualAddressList,                                                            \
+            sizeof(HV_INPUT_FLUSH_VIRTUAL_ADDRESS_LIST), 0,                                           \
+            sizeof(HV_GVA), 0, 1)                                                                     \
+    _Entry_(HvCallSendSyntheticClusterIpi,                                                            \
+            sizeof(HV_INPUT_SEND_SYNTHETIC_CLUSTER_IPI), 0,                                           \
+            0, 0, 0)                                                                                  \
+    _Entry_(HvCallFlushVirtualAddressSpaceEx,                                                         \
+            sizeof(HV_INPUT_FLUSH_VIRTUAL_ADDRESS_SPACE_EX), 0,                                       \
+            0, 0, 0)                                                                                  \
+    _Entry_(HvCallFlushVirtualAddressListEx,                                                          \
+            sizeof(HV_INPUT_FLUSH_VIRTUAL_ADDRESS_LIST_EX), 0,                                        \
+            sizeof(HV_GVA), 0, 1)                                                                     \
+    _Entry_(HvCallSendSyntheticClusterIpiEx,                                                          \
+            sizeof(HV_INPUT_SEND_SYNTHETIC_CLUSTER_IPI_EX), 0,                                        \
+            0, 0, 0)                                                                                  \
+    _Entry_(HvCallGetLogicalProcessorRunTime,                                                         \
+            0, sizeof(HV_OUTPUT_GET_LOGICAL_PROCESSOR_RUN_TIME),                                      \
+            0, 0, 0)                                                                                  \
+    _Entry_(HvCallNotifyLongSpinWait,                                                                 \
+            sizeof(HV_INPUT_NOTIFY_LONG_SPINWAIT), 0,                                                 \
+            0, 0, 0)                                                                                  \
+    _Entry_(HvCallInvokeHypervisorDebugger,                                                           \
+            sizeof(HV_INPUT_INVOKE_HYPERVISOR_DEBUGGER), 0,                                           \
+            0, 0, 0)                                                                                  \
+    _Entry_(HvCallCreatePartition,                                                                    \
+            sizeof(HV_INPUT_CREATE_PARTITION), sizeof(HV_OUTPUT_CREATE_PARTITION),                    \
+            0, 0, 0)                                                                                  \
+    _Entry_(HvCallInitializePartition,                                                                \
+            sizeof(HV_INPUT_INITIALIZE_PARTITION), 0,                                                 \
+            0, 0, 0)                                                                                  \
+    _Entry_(HvCallFinalizePartition,                                                                  \
+            sizeof(HV_INPUT_FINALIZE_PARTITION), 0,                                                   \
+            0, 0, 0)                                                                                  \
+    _Entry_(HvCallDeletePartition,                                                                    \
+            sizeof(HV_INPUT_DELETE_PARTITION), 0,                                                     \
+            0, 0, 0)                                                                                  \
+    _Entry_(HvCallGetPartitionProperty,                                                               \
+            sizeof(HV_INPUT_GET_PARTITION_PROPERTY), sizeof(HV_OUTPUT_GET_PARTITION_PROPERTY),        \
+            0, 0, 0)                                                                                  \
+    _Entry_(HvCallSetPartitionProperty,                                                               \
+            sizeof(HV_INPUT_SET_PARTITION_PROPERTY), 0,                                               \
+            0, 0, 0)                                                                                  \
+    _Entry_(HvCallGetPartitionId,                                                                     \
+            0, sizeof(HV_OUTPUT_GET_PARTITION_ID),                                                    \
+            0, 0, 0)                                                                                  \
+    _Entry_(HvCallGetNextChildPartition,                                                              \
+            sizeof(HV_INPUT_GET_NEXT_CHILD_PARTITION), sizeof(HV_OUTPUT_GET_NEXT_CHILD_PARTITION),    \
+            0, 0, 0)                                                                                  \
+    _Entry_(HvCallDepositMemory,                                                                      \
+            sizeof(HV_INPUT_DEPOSIT_MEMORY), 0,                                                       \
+            sizeof(HV_GPA_PAGE_NUMBER), 0, 1)                                                         \
+    _Entry_(HvCallWithdrawMemory,                                                                     \
+            sizeof(HV_INPUT_WITHDRAW_MEMORY), 0,                                                      \
+            0, sizeof(HV_GPA_PAGE_NUMBER), 1)                                                         \
+    _Entry_(HvCallGetMemoryBalance,                                                                   \
+            sizeof(HV_INPUT_GET_MEMORY_BALANCE), sizeof(HV_OUTPUT_GET_MEMORY_BALANCE),                \
+            0, 0, 0)                                                                                  \
+    _Entry_(HvCallMapGpaPages,                                                                        \
+            sizeof(HV_INPUT_MAP_GPA_PAGES), 0,                                                        \
+            sizeof(HV_GPA_PAGE_NUMBER), 0, 1)                                                         \
+    _Entry_(HvCallUnmapGpaPages,                                                                      \
+            sizeof(HV_INPUT_UNMAP_GPA_PAGES), 0,                                                      \
+            0, 0, 1)                                                                                  \
+    _Entry_(HvCallInstallIntercept,                                                                   \
+            sizeof(HV_INPUT_INSTALL_INTERCEPT), 0,                                                    \
+            0, 0, 0)                                                                                  \
+    _Entry_(HvCallCreateVp,                                                                           \
+            sizeof(HV_INPUT_CREATE_VP), 0,                                                            \
+            0, 0, 0)                                                                                  \
+    _Entry_(HvCallDeleteVp,                                                                           \
+            sizeof(HV_INPUT_DELETE_VP), 0,                                                            \
+            0, 0, 0)                                                                                  \
+    _Entry_(HvCallGetVpRegisters,                                                                     \
+            sizeof(HV_INPUT_GET_VP_REGISTERS), 0,                                                     \
+            sizeof(HV_REGISTER_NAME), sizeof(HV_REGISTER_VALUE), 1)                                   \
+    _Entry_(HvCallSetVpRegisters,                                                                     \
+            sizeof(HV_INPUT_SET_VP_REGISTERS), 0,                                                     \
+            sizeof(HV_REGISTER_ASSOC), 0, 1)                                                          \
+    _Entry_(HvCallTranslateVirtualAddress,                                                            \
+            sizeof(HV_INPUT_TRANSLATE_VIRTUAL_ADDRESS), sizeof(HV_OUTPUT_TRANSLATE_VIRTUAL_ADDRESS),  \
+            0, 0, 0)                                                                                  \
+    _Entry_(HvCallReadGpa,                                                                            \
+            sizeof(HV_INPUT_READ_GPA), sizeof(HV_OUTPUT_READ_GPA),                                    \
+            0, 0, 0)                                                                                  \
+    _Entry_(HvCallWriteGpa,                                                                           \
+            sizeof(HV_INPUT_WRITE_GPA), sizeof(HV_OUTPUT_WRITE_GPA),                                  \
+            0, 0, 0)                                                                                  \
+    _Entry_(HvCallClearVirtualInterrupt,                                                              \
+            sizeof(HV_INPUT_CLEAR_VIRTUAL_INTERRUPT), 0,                                              \
+            0, 0, 0)                                                                                  \
+    _Entry_(HvCallDeletePort,                                                                         \
+            sizeof(HV_INPUT_DELETE_PORT), 0,                                                          \
+            0, 0, 0)                                                                                  \
+    _Entry_(HvCallGetPortProperty,                                                                    \
+            sizeof(HV_INPUT_GET_PORT_PROPERTY), sizeof(HV_OUTPUT_GET_PORT_PROPERTY),                  \
+            0, 0, 0)                                                                                  \
+    _Entry_(HvCallDisconnectPort,                                                                     \
+            sizeof(HV_INPUT_DISCONNECT_PORT), 0,                                                      \
+            0, 0, 0)                                                                                  \
+    _Entry_(HvCallPostMessage,                                                                        \
+            sizeof(HV_INPUT_POST_MESSAGE), 0,                                                         \
+            0, 0, 0)                                                                                  \
+    _Entry_(HvCallSignalEvent,                                                                        \
+            sizeof(HV_INPUT_SIGNAL_EVENT), 0,                                                         \
+            0, 0, 0)                                                                                  \
+    _Entry_(HvCallSavePartitionState,                                                                 \
+            sizeof(HV_INPUT_SAVE_PARTITION_STATE), sizeof(HV_OUTPUT_SAVE_PARTITION_STATE),            \
+            0, 0, 0)                                                                                  \
+    _Entry_(HvCallRestorePartitionState,                                                              \
+            sizeof(HV_INPUT_RESTORE_PARTITION_STATE), sizeof(HV_OUTPUT_RESTORE_PARTITION_STATE),      \
+            0, 0, 0)                                                                                  \
+    _Entry_(HvCallInitializeEventLogBufferGroup,                                                      \
+            sizeof(HV_INPUT_INITIALIZE_EVENTLOG_BUFFER_GROUP), 0,                                     \
+            0, 0, 0)                                                                                  \
+    _Entry_(HvCallFinalizeEventLogBufferGroup,                                                        \
+            sizeof(HV_INPUT_FINALIZE_EVENTLOG_BUFFER_GROUP), 0,                                       \
+            0, 0, 0)                                                                                  \
+    _Entry_(HvCallCreateEventLogBuffer,                                                               \
+            sizeof(HV_INPUT_CREATE_EVENTLOG_BUFFER), 0,                                               \
+            0, 0, 0)                                                                                  \
+    _Entry_(HvCallDeleteEventLogBuffer,                                                               \
+            sizeof(HV_INPUT_DELETE_EVENTLOG_BUFFER), 0,                                               \
+            0, 0, 0)                                                                                  \
+    _Entry_(HvCallMapEventLogBuffer,                                                                  \
+            sizeof(HV_INPUT_MAP_EVENTLOG_BUFFER), sizeof(HV_OUTPUT_MAP_EVENTLOG_BUFFER),              \
+            0, 0, 0)                                                                                  \
+    _Entry_(HvCallUnmapEventLogBuffer,                                                                \
+            sizeof(HV_INPUT_UNMAP_EVENTLOG_BUFFER), 0,                                                \
+            0, 0, 0)                                                                                  \
+    _Entry_(HvCallSetEventLogGroupSources,                                                            \
+            sizeof(HV_INPUT_EVENTLOG_SET_EVENTS), 0,                                                  \
+            0, 0, 0)                                                                                  \
+    _Entry_(HvCallReleaseEventLogBuffer,                                                              \
+            sizeof(HV_INPUT_EVENTLOG_RELEASE_BUFFER), 0,                                              \
+            0, 0, 0)                                                                                  \
+    _Entry_(HvCallFlushEventLogBuffer,                                                                \
+            sizeof(HV_INPUT_EVENTLOG_REQUEST_FLUSH), 0,                                               \
+            0, 0, 0)                                                                                  \
+    _Entry_(HvCallPostDebugData,                                                                      \
+            sizeof(HV_INPUT_POST_DEBUG_DATA), sizeof(HV_OUTPUT_POST_DEBUG_DATA),                      \
+            0, 0, 0)                                                                                  \
+    _Entry_(HvCallRetrieveDebugData,                                                                  \
+            sizeof(HV_INPUT_RETRIEVE_DEBUG_DATA), sizeof(HV_OUTPUT_RETRIEVE_DEBUG_DATA),              \
+            0, 0, 0)                                                                                  \
+    _Entry_(HvCallResetDebugSession,                                                                  \
+            sizeof(HV_INPUT_RESET_DEBUG_SESSION), 0,                                                  \
+            0, 0, 0)                                                                                  \
+    _Entry_(HvCallMapStatsPage,                                                                       \
+            sizeof(HV_INPUT_MAP_STATS_PAGE), 0,                                                       \
+            0, 0, 0)                                                                                  \
+    _Entry_(HvCallUnmapStatsPage,                                                                     \
+            sizeof(HV_INPUT_UNMAP_STATS_PAGE), 0,                                                     \
+            0, 0, 0)                                                                                  \
+    _Entry_(HvCallMapSparseGpaPages,                                                                  \
+            sizeof(HV_INPUT_MAP_SPARSE_GPA_PAGES), 0,                                                 \
+            sizeof(HV_GPA_MAPPING), 0, 1)                                                             \
+    _Entry_(HvCallSetSystemProperty,                                                                  \
+            sizeof(HV_INPUT_SET_SYSTEM_PROPERTY), 0,                                                  \
+            0, 0, 0)                                                                                  \
+    _Entry_(HvCallAssertVirtualInterrupt,                                                             \
+            sizeof(HV_INPUT_ASSERT_VIRTUAL_INTERRUPT), 0,                                             \
+            0, 0, 0)                                                                                  \
+    _Entry_(HvCallCreatePort,                                                                         \
+            sizeof(HV_INPUT_CREATE_PORT), 0,                                                          \
+            0, 0, 0)                                                                                  \
+    _Entry_(HvCallConnectPort,                                                                        \
+            sizeof(HV_INPUT_CONNECT_PORT), 0,                                                         \
+            0, 0, 0)
+
 //
 // Chapter 15 -- Virtual Secure Mode
 //